@@ -4,7 +4,13 @@
 #include <vector>
 #include <fstream>
 #include <chrono>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include <memory>
 #include "rollingHash.h"
+#include "fmIndex.h"
+#include "resultStream.h"
 
 using namespace std;
 
@@ -33,7 +39,7 @@ void printBanner() {
 /**
  * @brief Presents a menu with the different tasks this program can do.
  *
- * @return 0,1,2,3 or 4, depending on what the user wants to do.
+ * @return 0,1,2,3,4,5 or 6, depending on what the user wants to do.
  */
 unsigned short printMenu() {
 
@@ -45,6 +51,8 @@ unsigned short printMenu() {
 	cout << " # [2] Search Pattern with Rabin-Karp.           #" << endl;
 	cout << " # [3] Compare the Performance.                  #" << endl;
 	cout << " # [4] Export data for Statistical Analysis.     #" << endl;
+	cout << " # [5] Search Patterns with an FM-Index.         #" << endl;
+	cout << " # [6] Search Pattern with Boyer-Moore.          #" << endl;
 	cout << " #                                               #" << endl;
 	cout << " # [0] Quit.                                     #" << endl;
 	cout << " #                                               #" << endl;
@@ -62,7 +70,7 @@ unsigned short printMenu() {
 			option = 10;
 		}
 
-	} while (option < 0 || option > 4);
+	} while (option < 0 || option > 6);
 
 	cin.ignore(numeric_limits<streamsize>::max(), '\n'); //Remove the '\n' in the cin buffer so it doesn't mess with getline
 
@@ -73,6 +81,7 @@ unsigned short printMenu() {
  * @brief Scans a directory and returns a vector<string> with the paths of all the files in that directory and sub-directories.
  *
  * This function makes use of the new C++17 library Filesystem.
+ * The paths are sorted, so the results are always shown in the same order.
  *
  * @param directory The directory with the files that we want to search for the pattern.
  *
@@ -89,6 +98,8 @@ vector<string> getFiles(const string& directory) {
 			files.push_back(file.path().string()); //Add the file path to the vector
 	}
 
+	sort(files.begin(), files.end()); //The order of the directory iterator is unspecified
+
 	return files;
 }
 
@@ -155,7 +166,10 @@ string searchBoyerMooreHorspool(const string& patt, ifstream& file, const char&
 
 	while (getline(file, line)) { //Using getline because it's supposed to keep track of the lines where the pattern is present using the var lineNr
 
-		if (line.empty() || line.length() < patt.length()) continue; //Skip empty lines and small lines
+		if (line.empty() || line.length() < patt.length()) { //Skip empty lines and small lines, but keep counting them
+			lineNr++;
+			continue;
+		}
 
 		for (unsigned short i = 0; i <= line.length() - patt.length(); i++) {
 
@@ -192,6 +206,122 @@ string searchBoyerMooreHorspool(const string& patt, ifstream& file, const char&
 	return linesWithPatt;
 }
 
+/**
+ * @brief Implementation of the full Boyer-Moore algorithm for string searching.
+ *
+ * This function goes through a file and performs the Boyer-Moore algorithm to each line.
+ * Unlike Boyer-Moore-Horspool, the shift is the biggest of the bad-character rule and the (strong) good-suffix rule,
+ * and the Turbo-BM rule is used: after a good-suffix shift, the part of the window that is already known to match the pattern isn't compared again
+ * and a turbo-shift can skip past it. The scan stops at the first match in each line, so the classic Galil rule (which only applies after a full match) wouldn't help.
+ * The extra preprocessing pays off with long patterns and small alphabets, where the bad-character shifts are short.
+ *
+ * @param patt The pattern to be searched for.
+ * @param file The file to search the pattern.
+ * @param verbose whether the program is supposed to be verbose or not.
+ *
+ * @return string with all the lines where the pattern is present.
+ */
+string searchBoyerMoore(const string& patt, ifstream& file, const char& verbose) {
+
+	string linesWithPatt;
+	string line;
+	unsigned int lineNr = 1; //Starting from line 1
+
+	const int m = (int)patt.length();
+
+	if (!m) return linesWithPatt;
+
+	//Bad-character rule: last position of every char in the pattern (-1 if not present)
+	int lastPos[256];
+
+	for (unsigned short i = 0; i < 256; i++)
+		lastPos[i] = -1;
+
+	for (int i = 0; i < m; i++)
+		lastPos[(unsigned char)patt[i]] = i;
+
+	//Good-suffix rule: goodSuffix[j + 1] is the shift when patt[j] mismatches and patt[j + 1 ...] matched, goodSuffix[0] is the period of the pattern
+	vector<int> goodSuffix(m + 1, 0);
+	vector<int> border(m + 1); //border[i] = start of the widest border of patt[i ...]
+
+	int i = m;
+	int j = m + 1;
+	border[i] = j;
+
+	while (i > 0) { //The matched suffix is present somewhere else in the pattern, preceded by a different char
+		while (j <= m && patt[i - 1] != patt[j - 1]) {
+			if (!goodSuffix[j])
+				goodSuffix[j] = j - i;
+			j = border[j];
+		}
+		i--;
+		j--;
+		border[i] = j;
+	}
+
+	j = border[0];
+	for (i = 0; i <= m; i++) { //Only part of the matched suffix is a prefix of the pattern
+		if (!goodSuffix[i])
+			goodSuffix[i] = j;
+		if (i == j)
+			j = border[j];
+	}
+
+
+	while (getline(file, line)) { //Using getline because it's supposed to keep track of the lines where the pattern is present using the var lineNr
+
+		if (line.empty() || line.length() < patt.length()) { //Skip empty lines and small lines, but keep counting them
+			lineNr++;
+			continue;
+		}
+
+		int shift = m;
+		int memory = 0; //Length of the part of the current window that is known to match because of the last shift (Turbo-BM rule)
+
+		for (size_t pos = 0; pos <= line.length() - m; pos += shift) {
+
+			if (verbose == 'y')
+				showCurrentTest(patt, line, (unsigned short)pos); //Debuging
+
+			j = m - 1;
+			while (j >= 0 && patt[j] == line[pos + j]) {
+
+				if (verbose == 'y')
+					showCurrentTest(patt, line, (unsigned short)pos, j); //Debuging
+
+				j--;
+
+				if (memory && j == m - 1 - shift) //Skip the part that matched in the last window
+					j -= memory;
+			}
+
+			if (j < 0) { //Match found
+				if (linesWithPatt.empty())
+					linesWithPatt = "Line: " + to_string(lineNr) + " Char: " + to_string(pos + 1);
+				else
+					linesWithPatt += ", Line: " + to_string(lineNr) + " Char: " + to_string(pos + 1);
+				break;
+			}
+
+			int matched = m - 1 - j;
+			int turboShift = memory - matched;
+			int badCharShift = j - lastPos[(unsigned char)line[pos + j]];
+
+			shift = max(max(turboShift, badCharShift), goodSuffix[j + 1]);
+
+			if (shift == goodSuffix[j + 1])
+				memory = min(m - shift, matched); //The matched suffix will be aligned with a part of the pattern that is equal to it
+			else {
+				if (turboShift < badCharShift)
+					shift = max(shift, memory + 1);
+				memory = 0;
+			}
+		}
+		lineNr++;
+	}
+	return linesWithPatt;
+}
+
 /**
  * @brief Implementation of the Rabin-Karp algorithm for string searching.
  *
@@ -213,7 +343,10 @@ string searchRabinKarp(const string& patt, ifstream& file, const char& verbose)
 
 	while (getline(file, line)) { //Using getline beacuse it's supposed to keep track of the lines where the pattern is present
 
-		if (line.empty() || line.length() < patt.length()) continue; //Skip empty lines and small lines
+		if (line.empty() || line.length() < patt.length()) { //Skip empty lines and small lines, but keep counting them
+			lineNr++;
+			continue;
+		}
 
 
 		rollingHash text(line, (unsigned short)patt.length());
@@ -246,24 +379,58 @@ string searchRabinKarp(const string& patt, ifstream& file, const char& verbose)
 }
 
 /**
- * @brief Displays where the pattern is present on a file.
+ * @brief Searches for a pattern in every file with a given Algorithm and streams where the pattern is present on each file.
  *
- * This function takes a vector<string> with the location of the pattern in a file and prints it out.
+ * The files are split between several threads. Every result goes through a resultStream, so they are shown as soon as
+ * each file is done but always in the same order as the files.
  *
- * @param matches The location the pattern in a file.
- * @param nrFiles The number of files that were searched.
+ * @param pattern The pattern to be searched for.
+ * @param files The paths of the files to search the pattern.
+ * @param search The Algorithm (searchBoyerMooreHorspool, searchBoyerMoore or searchRabinKarp).
+ * @param verbose whether the program is supposed to be verbose or not. Verbose searches use a single thread, otherwise the output would be mixed up.
+ * @param results The stream where the results go.
+ * @param algo Text added after every result to identify the Algorithm.
+ * @param maxThreads The maximum amount of threads to use (0 = one for each core).
  */
-void printMatches(const vector<string>& matches, const unsigned short& nrFiles) {
+void searchFiles(const string& pattern, const vector<string>& files, string (*search)(const string&, ifstream&, const char&), const char& verbose, resultStream& results, const string& algo = "", const unsigned int& maxThreads = 0) {
 
-	//If nrFiles == 0 (i.e. if(true)) print the all the matches in all files
-	if (!nrFiles) {
-		for (const auto& match : matches)
-			cout << match << endl << endl;
-	}
-	else { //Print just one time the matches in the files (this prevents printing duplicates when using the loopSearches() to test the performance)
-		for (unsigned short i = 0; i < nrFiles; i++)
-			cout << matches[i] << endl << endl;
-	}
+	atomic<size_t> next(0); //Index of the next file to be searched
+
+	auto worker = [&]() {
+		for (size_t i = next++; i < files.size(); i = next++) {
+
+			ifstream file(files[i]);
+
+			if (!file.good()) {
+				results.pushError(i, "Error loading file: " + files[i]);
+				continue;
+			}
+
+			string linesWithPatt = search(pattern, file, verbose);
+
+			if (linesWithPatt.empty())
+				linesWithPatt = "Pattern not Found!";
+
+			results.push(i, files[i] + " => " + linesWithPatt + algo);
+
+			if (verbose == 'y')
+				results.flush(); //Show it before the output of the next file
+		}
+	};
+
+	unsigned int nrThreads = verbose == 'y' ? 1 : max(1u, thread::hardware_concurrency());
+
+	if (maxThreads)
+		nrThreads = min(nrThreads, maxThreads);
+	vector<thread> threads;
+
+	for (unsigned int i = 1; i < nrThreads && i < files.size(); i++)
+		threads.emplace_back(worker);
+
+	worker(); //This thread searches too
+
+	for (auto& t : threads)
+		t.join();
 }
 
 /**
@@ -272,89 +439,153 @@ void printMatches(const vector<string>& matches, const unsigned short& nrFiles)
  * This function takes a time interval and calculates the duration of that interval in milliseconds.
  *
  * @param start The time when the Algorithm started.
+ * @param firstResult The time when the first result was shown.
  * @param end The time when the Algorithm ended.
  * @param algo The name of the Algorithm.
  */
-void printPerformance(const chrono::steady_clock::time_point& start, const chrono::steady_clock::time_point& finish, const string& algo) {
+void printPerformance(const chrono::steady_clock::time_point& start, const chrono::steady_clock::time_point& firstResult, const chrono::steady_clock::time_point& finish, const string& algo) {
+	auto duration = chrono::duration_cast<chrono::milliseconds>(finish - start).count();
+	auto timeToFirstResult = chrono::duration_cast<chrono::milliseconds>(firstResult - start).count();
+
+	cout << algo << " took " << duration << " milliseconds to find pattern." << endl;
+	cout << "First result shown after " << timeToFirstResult << " milliseconds." << endl << endl;
+}
+
+/**
+ * @brief Displays how long the FM-Index took to be built and how much memory it uses.
+ *
+ * @param start The time when the build started.
+ * @param finish The time when the build ended.
+ * @param index The FM-Index that was built.
+ */
+void printIndexSize(const chrono::steady_clock::time_point& start, const chrono::steady_clock::time_point& finish, fmIndex& index) {
 	auto duration = chrono::duration_cast<chrono::milliseconds>(finish - start).count();
 
-	cout << algo << " took " << duration << " milliseconds to find pattern." << endl << endl;
+	cout << "FM-Index took " << duration << " milliseconds to build." << endl;
+	cout << "FM-Index uses " << index.memoryUsage() / 1024 << " KB of memory to index " << index.corpusSize() / 1024 << " KB of text." << endl << endl;
 }
 
 /**
- * @brief Runs both Algorithms a certain amount of times to test performance.
+ * @brief Runs the Algorithms a certain amount of times to test performance.
  *
- * This function takes a pattern and a directory and searches for the pattern in the files of that directory with both string-searching Algorithms over and over again to analyse their performance.
+ * This function takes a pattern and a directory and searches for the pattern in the files of that directory with the string-searching Algorithms over and over again to analyse their performance.
+ * The results are shown by an extra, untimed pass before the timed ones.
+ * Optionally, the same searches are also done with an FM-Index of the files, built only once, to show after how many queries indexing pays off.
  *
  * @param patt The pattern to be searched for.
  * @param directory The directory with the files that we want to search for the pattern.
  * @param times The amount of times the function will repeat the search.
  * @param save Whether the function will export the performace of the Algorithms to a file or not.
+ * @param withIndex Whether the FM-Index is also compared or not. Building it loads every file into memory.
  */
-void loopSearches(const string& pattern, const string& directory, const unsigned short& times, const string& save = "") {
+void loopSearches(const string& pattern, const string& directory, const unsigned short& times, const string& save = "", const bool& withIndex = false) {
 	vector<string> files = getFiles(directory);
 
-	string linesWithPatt;
-
-	vector<string> matchesBM;
-	vector<string> matchesRK;
-
 	vector<unsigned int> valuesBM;
+	vector<unsigned int> valuesBMGS;
 	vector<unsigned int> valuesRK;
 
+	vector<unsigned int> valuesFM; //In microseconds, a query takes way less than a millisecond
+
+	//Time to the first result of the pass that shows the results
+	unsigned long long firstResultBM = 0;
+	unsigned long long firstResultBMGS = 0;
+	unsigned long long firstResultRK = 0;
+	unsigned long long firstResultFM = 0;
+
+	unsigned long long totalMicrosecondsBM = 0; //Boyer-Moore-Horspool with the same resolution as the FM-Index, for the break-even point
+
+	unique_ptr<fmIndex> index;
+
+	auto startBuild = chrono::steady_clock::now();
+	if (withIndex) {
+		index = make_unique<fmIndex>(files);
+
+		if (!index->good())
+			index.reset();
+	}
+	auto finishBuild = chrono::steady_clock::now();
+
+	cout << endl << endl;
+
+	//The results are shown only once, in an untimed pass before the timed ones, so writing them to the screen isn't counted in the times
+	{
+		resultStream resultsBM(files.size());
+		searchFiles(pattern, files, searchBoyerMooreHorspool, false, resultsBM, " (BM)", 1);
+		resultsBM.end();
+		firstResultBM = chrono::duration_cast<chrono::milliseconds>(resultsBM.getFirstResult() - resultsBM.getStart()).count();
+
+		resultStream resultsBMGS(files.size());
+		searchFiles(pattern, files, searchBoyerMoore, false, resultsBMGS, " (BMGS)", 1);
+		resultsBMGS.end();
+		firstResultBMGS = chrono::duration_cast<chrono::milliseconds>(resultsBMGS.getFirstResult() - resultsBMGS.getStart()).count();
+
+		resultStream resultsRK(files.size());
+		searchFiles(pattern, files, searchRabinKarp, false, resultsRK, " (RK)", 1);
+		resultsRK.end();
+		firstResultRK = chrono::duration_cast<chrono::milliseconds>(resultsRK.getFirstResult() - resultsRK.getStart()).count();
+
+		if (index) {
+			resultStream resultsFM(files.size());
+			vector<string> linesFM = index->locate(pattern);
+
+			for (size_t j = 0; j < files.size(); j++)
+				resultsFM.push(j, files[j] + " => " + (linesFM[j].empty() ? "Pattern not Found!" : linesFM[j]) + " (FM)");
+			resultsFM.end();
+			firstResultFM = chrono::duration_cast<chrono::microseconds>(resultsFM.getFirstResult() - resultsFM.getStart()).count();
+		}
+	}
+
 	for (unsigned short i = 0; i < times; i++) {
 
+		//The files are searched by a single thread and nothing is written to the screen, so the times only depend on the Algorithms (and can be compared with previously exported values)
+
 		////////////////////////////////// Boyer-Moore-Horspool //////////////////////////////////////
-		auto startBM = chrono::steady_clock::now();
-		for (const auto& filePath : files) {
+		resultStream resultsBM(files.size(), false);
 
-			ifstream file(filePath);
+		searchFiles(pattern, files, searchBoyerMooreHorspool, false, resultsBM, " (BM)", 1);
+		resultsBM.end();
 
-			if (!file.good()) {
-				cerr << "Error loading file: " << filePath << endl << endl;
-				continue;
-			}
-			linesWithPatt = searchBoyerMooreHorspool(pattern, file, false);
+		valuesBM.push_back((unsigned int)chrono::duration_cast<chrono::milliseconds>(resultsBM.getFinish() - resultsBM.getStart()).count());
+		totalMicrosecondsBM += chrono::duration_cast<chrono::microseconds>(resultsBM.getFinish() - resultsBM.getStart()).count();
+		/////////////////////////////////////////////////////////////////////////////////////////////
 
-			if (linesWithPatt.empty())
-				linesWithPatt = "Pattern not Found!";
+		////////////////////////////////////// Boyer-Moore //////////////////////////////////////////
+		resultStream resultsBMGS(files.size(), false);
 
-			matchesBM.push_back(filePath + " => " + linesWithPatt + " (BM)");
-		}
-		auto finishBM = chrono::steady_clock::now();
+		searchFiles(pattern, files, searchBoyerMoore, false, resultsBMGS, " (BMGS)", 1);
+		resultsBMGS.end();
 
-		valuesBM.push_back((unsigned int)chrono::duration_cast<chrono::milliseconds>(finishBM - startBM).count());
+		valuesBMGS.push_back((unsigned int)chrono::duration_cast<chrono::milliseconds>(resultsBMGS.getFinish() - resultsBMGS.getStart()).count());
 		/////////////////////////////////////////////////////////////////////////////////////////////
 
 		////////////////////////////////////// Rabin-Karp //////////////////////////////////////////
-		auto startRK = chrono::steady_clock::now();
-		for (const auto& filePath : files) {
+		resultStream resultsRK(files.size(), false);
 
-			ifstream file(filePath);
+		searchFiles(pattern, files, searchRabinKarp, false, resultsRK, " (RK)", 1);
+		resultsRK.end();
 
-			if (!file.good()) {
-				cerr << "Error loading file: " << filePath << endl << endl;
-				continue;
-			}
-			linesWithPatt = searchRabinKarp(pattern, file, false);
+		valuesRK.push_back((unsigned int)chrono::duration_cast<chrono::milliseconds>(resultsRK.getFinish() - resultsRK.getStart()).count());
+		/////////////////////////////////////////////////////////////////////////////////////////////
 
-			if (linesWithPatt.empty())
-				linesWithPatt = "Pattern not Found!";
+		/////////////////////////////////////// FM-Index ///////////////////////////////////////////
+		if (index) {
+			resultStream resultsFM(files.size(), false);
 
-			matchesRK.push_back(filePath + " => " + linesWithPatt + " (RK)");
-		}
-		auto finishRK = chrono::steady_clock::now();
+			vector<string> linesFM = index->locate(pattern);
 
-		valuesRK.push_back((unsigned int)chrono::duration_cast<chrono::milliseconds>(finishRK - startRK).count());
-		/////////////////////////////////////////////////////////////////////////////////////////////
+			for (size_t j = 0; j < files.size(); j++)
+				resultsFM.push(j, files[j] + " => " + (linesFM[j].empty() ? "Pattern not Found!" : linesFM[j]) + " (FM)");
+			resultsFM.end();
 
-		if (matchesBM.size() != matchesRK.size()) {
-			cerr << "Something went wrong." << endl;
-			break;
+			valuesFM.push_back((unsigned int)chrono::duration_cast<chrono::microseconds>(resultsFM.getFinish() - resultsFM.getStart()).count());
 		}
+		/////////////////////////////////////////////////////////////////////////////////////////////
 	}
 	unsigned int avgDurationBM = 0;
+	unsigned int avgDurationBMGS = 0;
 	unsigned int avgDurationRK = 0;
+	unsigned long long avgDurationFM = 0;
 
 	//If a name for the files was specified
 	if (!save.empty()) {
@@ -367,6 +598,14 @@ void loopSearches(const string& pattern, const string& directory, const unsigned
 		}
 		outBM.close();
 
+		ofstream outBMGS(save + "_BMGS.txt");
+
+		for (const auto& value : valuesBMGS) {
+			avgDurationBMGS += value;
+			outBMGS << value << endl;
+		}
+		outBMGS.close();
+
 		ofstream outRK(save + "_RK.txt");
 
 		for (const auto& value : valuesRK) {
@@ -382,17 +621,37 @@ void loopSearches(const string& pattern, const string& directory, const unsigned
 		for (const auto& value : valuesBM)
 			avgDurationBM += value;
 
+		for (const auto& value : valuesBMGS)
+			avgDurationBMGS += value;
+
 		for (const auto& value : valuesRK)
 			avgDurationRK += value;
 	}
 
-	cout << endl << endl;
+	for (const auto& value : valuesFM)
+		avgDurationFM += value;
+
+	cout << "Pattern length: " << pattern.length() << " characters." << endl;
+	cout << "Average of Boyer-Moore-Horspool: " << avgDurationBM / valuesBM.size() << " milliseconds (first result shown after " << firstResultBM << " milliseconds)." << endl;
+	cout << "Average of Boyer-Moore: " << avgDurationBMGS / valuesBMGS.size() << " milliseconds (first result shown after " << firstResultBMGS << " milliseconds)." << endl;
+	cout << "Average of Rabin-Karp: " << avgDurationRK / valuesRK.size() << " milliseconds (first result shown after " << firstResultRK << " milliseconds)." << endl << endl;
+
+	if (!index) return;
 
-	printMatches(matchesBM, (unsigned short)files.size());
-	printMatches(matchesRK, (unsigned short)files.size());
+	cout << "Average of FM-Index: " << avgDurationFM / valuesFM.size() << " microseconds (first result shown after " << firstResultFM << " microseconds)." << endl << endl;
 
-	cout << "Average of Boyer-Moore-Horspool: " << avgDurationBM / valuesBM.size() << " milliseconds." << endl;
-	cout << "Average of Rabin-Karp: " << avgDurationRK / valuesRK.size() << " milliseconds." << endl << endl;
+	printIndexSize(startBuild, finishBuild, *index);
+
+	//Amount of queries needed for the time spent building the index to be recovered, compared to scanning the files with Boyer-Moore-Horspool
+	unsigned long long buildDuration = chrono::duration_cast<chrono::microseconds>(finishBuild - startBuild).count();
+	unsigned long long savedPerQuery = totalMicrosecondsBM / valuesBM.size();
+
+	if (savedPerQuery > avgDurationFM / valuesFM.size()) {
+		savedPerQuery -= avgDurationFM / valuesFM.size();
+		cout << "FM-Index pays off against Boyer-Moore-Horspool after " << (buildDuration + savedPerQuery - 1) / savedPerQuery << " queries." << endl << endl;
+	}
+	else
+		cout << "FM-Index doesn't pay off against Boyer-Moore-Horspool for this corpus." << endl << endl;
 }
 
 /**
@@ -410,6 +669,8 @@ void pauseScreen() {
 
 int main(int argc, char** argv) {
 
+	ios::sync_with_stdio(false); //The results are written in batches by resultStream, there's no need to keep cout in sync with stdio
+
 	if (argc == 1) {
 		//Interactive Mode
 		string pattern;
@@ -429,7 +690,7 @@ int main(int argc, char** argv) {
 
 			case 0: break;
 
-			case 1: //BM
+			case 1: case 6: //1: BMH, 6: BM
 			{
 				cout << endl << "Enter the Pattern to search for: ";
 				getline(cin, pattern);
@@ -450,30 +711,19 @@ int main(int argc, char** argv) {
 
 				files = getFiles(directory);
 
-				string linesWithPatt;
-				vector<string> matches;
-
-				for (const auto& filePath : files) {
-
-					ifstream file(filePath);
-
-					if (!file.good()) {
-						cerr << "Error loading file: " << filePath << endl << endl;
-						continue;
-					}
-
-					linesWithPatt = searchBoyerMooreHorspool(pattern, file, verbose);
+				cout << endl << endl;
 
-					if (linesWithPatt.empty())
-						linesWithPatt = "Pattern not Found!";
+				//Matches with BMH or BM
+				resultStream results(files.size());
 
-					matches.push_back(filePath + " => " + linesWithPatt);
-				}
+				if (option == 1)
+					searchFiles(pattern, files, searchBoyerMooreHorspool, verbose, results);
+				else
+					searchFiles(pattern, files, searchBoyerMoore, verbose, results);
 
-				cout << endl << endl;
+				results.end();
 
-				//Matches with BM
-				printMatches(matches, 0);
+				printPerformance(results.getStart(), results.getFirstResult(), results.getFinish(), option == 1 ? "Boyer-Moore-Horspool" : "Boyer-Moore");
 
 				pauseScreen();
 
@@ -501,30 +751,16 @@ int main(int argc, char** argv) {
 
 				files = getFiles(directory);
 
-				string linesWithPatt;
-				vector<string> matches;
-
-				for (const auto& filePath : files) {
-
-					ifstream file(filePath);
-
-					if (!file.good()) {
-						cerr << "Error loading file: " << filePath << endl << endl;
-						continue;
-					}
+				cout << endl << endl;
 
-					linesWithPatt = searchRabinKarp(pattern, file, verbose);
+				//Matches with RK
+				resultStream results(files.size());
 
-					if (linesWithPatt.empty())
-						linesWithPatt = "Pattern not Found!";
+				searchFiles(pattern, files, searchRabinKarp, verbose, results);
 
-					matches.push_back(filePath + " => " + linesWithPatt);
-				}
+				results.end();
 
-				cout << endl << endl;
-
-				//Matches with RK
-				printMatches(matches, 0);
+				printPerformance(results.getStart(), results.getFirstResult(), results.getFinish(), "Rabin-Karp");
 
 				pauseScreen();
 
@@ -552,15 +788,28 @@ int main(int argc, char** argv) {
 
 				} while (times < 1);
 
+				char withIndex = 0;
+
+				do {
+					cout << endl << "Also compare with an FM-Index (every file will be loaded into memory)? (y/n): ";
+					cin >> withIndex;
+
+					// prevents bad input to mess with cin
+					if (cin.fail()) {
+						cin.clear();
+						cin.ignore(numeric_limits<streamsize>::max(), '\n');
+					}
+				} while (withIndex != 'y' && withIndex != 'n');
+
 				if (option == 3)
-					loopSearches(pattern, directory, times);
+					loopSearches(pattern, directory, times, "", withIndex == 'y');
 				else if (option == 4) {
 					string save;
 
 					cout << endl << "Enter the Name of the files to export: ";
 					getline(cin >> ws, save);
 
-					loopSearches(pattern, directory, times, save);
+					loopSearches(pattern, directory, times, save, withIndex == 'y');
 				}
 				else cerr << "Something went wrong." << endl;
 
@@ -568,6 +817,57 @@ int main(int argc, char** argv) {
 
 				break;
 			}
+			case 5: //FM-Index
+			{
+				cout << endl << "Enter the Directory with the file(s) to be indexed: ";
+				getline(cin, directory);
+
+				files = getFiles(directory);
+
+				auto startBuild = chrono::steady_clock::now();
+				fmIndex index(files); //Built only once, every pattern searched afterwards uses the same index
+				auto finishBuild = chrono::steady_clock::now();
+
+				cout << endl;
+
+				if (!index.good()) {
+					pauseScreen();
+					break;
+				}
+
+				printIndexSize(startBuild, finishBuild, index);
+
+				while (true) {
+					cout << "Enter the Pattern to search for (leave empty to go back to the menu): ";
+					getline(cin, pattern);
+
+					if (pattern.empty()) break;
+
+					auto startCount = chrono::steady_clock::now();
+					unsigned int occurrences = index.count(pattern);
+					auto finishCount = chrono::steady_clock::now();
+
+					auto startLocate = chrono::steady_clock::now();
+					vector<string> linesWithPatt = index.locate(pattern);
+					auto finishLocate = chrono::steady_clock::now();
+
+					cout << endl << endl;
+
+					//Matches with the FM-Index
+					resultStream results(files.size());
+
+					for (size_t i = 0; i < files.size(); i++)
+						results.push(i, files[i] + " => " + (linesWithPatt[i].empty() ? "Pattern not Found!" : linesWithPatt[i]));
+
+					results.end();
+
+					cout << "Pattern found " << occurrences << " time(s)." << endl;
+					cout << "Count took " << chrono::duration_cast<chrono::microseconds>(finishCount - startCount).count() << " microseconds." << endl;
+					cout << "Locate took " << chrono::duration_cast<chrono::microseconds>(finishLocate - startLocate).count() << " microseconds." << endl << endl;
+				}
+
+				break;
+			}
 			default:
 				cerr << "Invalid Option!" << endl;
 				break;
@@ -0,0 +1,443 @@
+#include "fmIndex.h"
+
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <bitset>
+
+/**
+ * @brief Constructor of the fmIndex Class.
+ *
+ * Loads every file into a single corpus (each line followed by '\n', so a pattern can never match across lines) and builds the FM-index of that corpus:
+ * suffix array (SA-IS) -> Burrows-Wheeler Transform -> occurrences table with checkpoints + sampled suffix array.
+ * Only the compressed structures are kept, the corpus itself and the full suffix array are discarded at the end.
+ * If the corpus is bigger than maxCorpusSize the index isn't built and good() returns false.
+ *
+ * @param files The paths of the files to be indexed.
+ */
+fmIndex::fmIndex(const std::vector<std::string>& files) { //O(N), N=corpus length
+
+	std::string text;
+	std::string line;
+	bool tooBig = false;
+
+	for (const auto& filePath : files) {
+
+		fileFirstLine.push_back((unsigned int)lineStarts.size());
+
+		std::ifstream file(filePath);
+
+		if (!file.good()) {
+			std::cerr << "Error loading file: " << filePath << std::endl << std::endl;
+			continue;
+		}
+
+		while (!tooBig && std::getline(file, line)) { //Using getline so the lines are split exactly like the other algorithms do
+
+			if (text.size() + line.size() + 1 > maxCorpusSize) {
+				tooBig = true;
+				break;
+			}
+			lineStarts.push_back((unsigned int)text.size());
+			text += line;
+			text += '\n';
+		}
+	}
+
+	if (tooBig) {
+		std::cerr << "The files are too big to be indexed (more than " << maxCorpusSize << " characters)." << std::endl << std::endl;
+
+		lineStarts.clear();
+		fileFirstLine.assign(files.size(), 0);
+		for (auto& c : code)
+			c = -1;
+		return; //bwt stays empty, so nothing is ever found
+	}
+
+	const unsigned int n = (unsigned int)text.size() + 1; //+1 for the sentinel, a virtual char smaller than every other char at the end of the corpus
+
+	//////////////////////////////////// Compact Alphabet ////////////////////////////////////
+	unsigned int freq[256] = {};
+
+	for (const auto& c : text)
+		freq[(unsigned char)c]++;
+
+	for (unsigned short c = 0; c < 256; c++)
+		code[c] = freq[c] ? sigma++ : -1;
+
+	C.assign(sigma + 1, 0);
+	C[0] = 1; //The sentinel comes before everything else
+
+	for (unsigned short c = 0; c < 256; c++)
+		if (code[c] != -1)
+			C[code[c] + 1] = C[code[c]] + freq[c];
+	//////////////////////////////////////////////////////////////////////////////////////////
+
+	////////////////////////////////////// Suffix Array //////////////////////////////////////
+	std::vector<int> codes(n - 1);
+
+	for (unsigned int i = 0; i < n - 1; i++)
+		codes[i] = code[(unsigned char)text[i]];
+
+	std::vector<int> sa = suffixArray(codes, sigma ? sigma - 1 : 0);
+	sa.insert(sa.begin(), n - 1); //The suffix with just the sentinel is the smallest one
+
+	std::vector<int>().swap(codes);
+	//////////////////////////////////////////////////////////////////////////////////////////
+
+	/////////////////////////////// Burrows-Wheeler Transform ////////////////////////////////
+	bwt.resize(n);
+
+	for (unsigned int i = 0; i < n; i++) {
+		if (sa[i] == 0) { //The char before the whole corpus is the sentinel
+			primary = i;
+			bwt[i] = 0;
+		}
+		else
+			bwt[i] = (unsigned char)text[sa[i] - 1];
+	}
+	std::string().swap(text);
+	//////////////////////////////////////////////////////////////////////////////////////////
+
+	/////////////////////////////////// Occurrences Table ////////////////////////////////////
+	std::vector<unsigned int> running(sigma, 0);
+
+	occ.assign(((size_t)n / checkpointRate + 1) * sigma, 0);
+
+	for (unsigned int i = 0; i <= n; i++) { //i == n too, backwardSearch starts by asking for the rank of the whole BWT
+		if (i % checkpointRate == 0)
+			std::copy(running.begin(), running.end(), occ.begin() + (size_t)(i / checkpointRate) * sigma);
+
+		if (i < n && i != primary)
+			running[code[bwt[i]]]++;
+	}
+	//////////////////////////////////////////////////////////////////////////////////////////
+
+	////////////////////////////////// Sampled Suffix Array //////////////////////////////////
+	sampledRows.assign(n / 64 + 1, 0);
+
+	for (unsigned int i = 0; i < n; i++) {
+		if (sa[i] % sampleRate == 0) {
+			sampledRows[i / 64] |= 1ULL << (i % 64);
+			samples.push_back(sa[i]);
+		}
+	}
+
+	sampledRank.assign(sampledRows.size(), 0);
+	for (size_t i = 1; i < sampledRows.size(); i++)
+		sampledRank[i] = sampledRank[i - 1] + (unsigned int)std::bitset<64>(sampledRows[i - 1]).count();
+	//////////////////////////////////////////////////////////////////////////////////////////
+}
+
+/**
+ * @brief Builds the suffix array of a string with the SA-IS algorithm.
+ *
+ * The suffixes are classified as S-type (smaller than the next suffix) or L-type (bigger). Sorting the LMS substrings
+ * (the ones that start with an S-type suffix preceded by an L-type suffix) is enough to induce the order of every other suffix.
+ * If two LMS substrings are equal, their order is found by building the suffix array of the reduced string recursively.
+ * A suffix that is a prefix of another suffix is the smaller one, as if there was a sentinel at the end.
+ *
+ * @param s The string, with every char in [0, upper].
+ * @param upper The biggest char of the string.
+ *
+ * @return vector<int> with the start of every suffix of the string, in lexicographical order.
+ */
+std::vector<int> fmIndex::suffixArray(const std::vector<int>& s, const int& upper) { //O(N), N=string length
+
+	int n = (int)s.size();
+
+	if (n == 0) return {};
+	if (n == 1) return { 0 };
+	if (n == 2) return s[0] < s[1] ? std::vector<int>{ 0, 1 } : std::vector<int>{ 1, 0 };
+
+	std::vector<int> sa(n);
+	std::vector<bool> isS(n); //S-type or L-type
+
+	for (int i = n - 2; i >= 0; i--)
+		isS[i] = (s[i] == s[i + 1]) ? isS[i + 1] : (s[i] < s[i + 1]);
+
+	//Where the bucket of every char starts: L-type suffixes come first in each bucket, then S-type suffixes
+	std::vector<int> sumL(upper + 1), sumS(upper + 1);
+
+	for (int i = 0; i < n; i++) {
+		if (!isS[i])
+			sumS[s[i]]++;
+		else
+			sumL[s[i] + 1]++;
+	}
+	for (int i = 0; i <= upper; i++) {
+		sumS[i] += sumL[i];
+		if (i < upper)
+			sumL[i + 1] += sumS[i];
+	}
+
+	//Places the LMS suffixes in their buckets and induces the order of the L-type and then the S-type suffixes
+	auto induce = [&](const std::vector<int>& lms) {
+		std::fill(sa.begin(), sa.end(), -1);
+		std::vector<int> buf(sumS);
+
+		for (const auto& d : lms)
+			if (d != n)
+				sa[buf[s[d]]++] = d;
+
+		buf = sumL;
+		sa[buf[s[n - 1]]++] = n - 1;
+		for (int i = 0; i < n; i++) {
+			int v = sa[i];
+			if (v >= 1 && !isS[v - 1])
+				sa[buf[s[v - 1]]++] = v - 1;
+		}
+
+		buf = sumL;
+		for (int i = n - 1; i >= 0; i--) {
+			int v = sa[i];
+			if (v >= 1 && isS[v - 1])
+				sa[--buf[s[v - 1] + 1]] = v - 1;
+		}
+	};
+
+	std::vector<int> lmsMap(n + 1, -1);
+	std::vector<int> lms;
+
+	for (int i = 1; i < n; i++) {
+		if (!isS[i - 1] && isS[i]) {
+			lmsMap[i] = (int)lms.size();
+			lms.push_back(i);
+		}
+	}
+	int m = (int)lms.size();
+
+	induce(lms);
+
+	if (m) {
+		std::vector<int> sortedLms;
+		sortedLms.reserve(m);
+
+		for (const auto& v : sa)
+			if (lmsMap[v] != -1)
+				sortedLms.push_back(v);
+
+		//Name the LMS substrings, equal substrings get the same name
+		std::vector<int> reduced(m);
+		int reducedUpper = 0;
+		reduced[lmsMap[sortedLms[0]]] = 0;
+
+		for (int i = 1; i < m; i++) {
+			int l = sortedLms[i - 1], r = sortedLms[i];
+			int endL = (lmsMap[l] + 1 < m) ? lms[lmsMap[l] + 1] : n;
+			int endR = (lmsMap[r] + 1 < m) ? lms[lmsMap[r] + 1] : n;
+			bool same = true;
+
+			if (endL - l != endR - r)
+				same = false;
+			else {
+				while (l < endL && s[l] == s[r]) {
+					l++;
+					r++;
+				}
+				if (l == n || s[l] != s[r])
+					same = false;
+			}
+			if (!same)
+				reducedUpper++;
+			reduced[lmsMap[sortedLms[i]]] = reducedUpper;
+		}
+
+		std::vector<int> reducedSa = suffixArray(reduced, reducedUpper);
+
+		for (int i = 0; i < m; i++)
+			sortedLms[i] = lms[reducedSa[i]];
+
+		induce(sortedLms);
+	}
+	return sa;
+}
+
+/**
+ * @brief Destructor of the fmIndex Class.
+ */
+fmIndex::~fmIndex() {}
+
+/**
+ * @brief Counts the occurrences of a char in the first rows of the BWT.
+ *
+ * Starts from the closest checkpoint before the row and scans the rest of the BWT (at most checkpointRate chars).
+ *
+ * @param c The char to count (must be present in the corpus).
+ * @param row The number of rows of the BWT to look at.
+ *
+ * @return unsigned int with the amount of occurrences of the char in bwt[0, row).
+ */
+unsigned int fmIndex::rank(const unsigned char& c, const unsigned int& row) { //O(1)
+
+	unsigned int cp = row / checkpointRate;
+	unsigned int r = occ[(size_t)cp * sigma + code[c]];
+
+	for (unsigned int i = cp * checkpointRate; i < row; i++)
+		if (bwt[i] == c && i != primary)
+			r++;
+
+	return r;
+}
+
+/**
+ * @brief Last-to-First mapping.
+ *
+ * @param row A row of the BWT (other than the row of the sentinel).
+ *
+ * @return unsigned int with the row of the suffix that starts one char before the suffix of this row.
+ */
+unsigned int fmIndex::LF(const unsigned int& row) {
+	return C[code[bwt[row]]] + rank(bwt[row], row);
+}
+
+/**
+ * @brief Checks if the suffix array value of a row of the BWT was sampled.
+ *
+ * @param row A row of the BWT.
+ *
+ * @return true if it was sampled, false otherwise.
+ */
+bool fmIndex::isSampled(const unsigned int& row) {
+	return (sampledRows[row / 64] >> (row % 64)) & 1;
+}
+
+/**
+ * @brief Finds the range of rows of the BWT whose suffixes start with the pattern.
+ *
+ * Goes through the pattern from the last char to the first one, narrowing the range at each step.
+ *
+ * @param patt The pattern to be searched for.
+ * @param lo Gets the first row of the range.
+ * @param hi Gets the row after the last row of the range.
+ *
+ * @return true if the pattern is present, false otherwise.
+ */
+bool fmIndex::backwardSearch(const std::string& patt, unsigned int& lo, unsigned int& hi) { //O(M), M=pattern length
+
+	if (patt.empty() || bwt.size() <= 1) return false;
+
+	lo = 0;
+	hi = (unsigned int)bwt.size();
+
+	for (size_t i = patt.length(); i-- > 0;) {
+
+		unsigned char c = (unsigned char)patt[i];
+
+		if (code[c] == -1) return false; //Char not present in the corpus
+
+		lo = C[code[c]] + rank(c, lo);
+		hi = C[code[c]] + rank(c, hi);
+
+		if (lo >= hi) return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Counts how many times the pattern is present in the corpus.
+ *
+ * Every occurrence is counted, including more than one in the same line.
+ *
+ * @param patt The pattern to be searched for.
+ *
+ * @return unsigned int with the amount of occurrences.
+ */
+unsigned int fmIndex::count(const std::string& patt) { //O(M), M=pattern length
+
+	unsigned int lo, hi;
+
+	if (!backwardSearch(patt, lo, hi)) return 0;
+
+	return hi - lo;
+}
+
+/**
+ * @brief Finds where the pattern is present in every file of the corpus.
+ *
+ * The occurrences are mapped back to their file, line and char. Just like the other algorithms, only the first occurrence in each line is reported.
+ *
+ * @param patt The pattern to be searched for.
+ *
+ * @return vector<string> with all the lines where the pattern is present, one string for each file (in the same order they were passed to the constructor).
+ */
+std::vector<std::string> fmIndex::locate(const std::string& patt) { //O(M + occ * sampleRate), M=pattern length, occ=number of occurrences
+
+	std::vector<std::string> linesWithPatt(fileFirstLine.size());
+	std::vector<unsigned int> positions;
+	unsigned int lo, hi;
+
+	if (!backwardSearch(patt, lo, hi)) return linesWithPatt;
+
+	for (unsigned int row = lo; row < hi; row++) {
+
+		unsigned int r = row;
+		unsigned int steps = 0;
+
+		//Walk backwards through the corpus until a sampled suffix is found
+		while (!isSampled(r)) {
+			r = LF(r);
+			steps++;
+		}
+
+		unsigned int idx = sampledRank[r / 64] + (unsigned int)std::bitset<64>(sampledRows[r / 64] & ((1ULL << (r % 64)) - 1)).count();
+		positions.push_back(samples[idx] + steps);
+	}
+
+	std::sort(positions.begin(), positions.end());
+
+	size_t lastLine = lineStarts.size();
+
+	for (const auto& pos : positions) {
+
+		size_t line = std::upper_bound(lineStarts.begin(), lineStarts.end(), pos) - lineStarts.begin() - 1;
+
+		if (line == lastLine) continue; //Only the first occurrence in each line
+		lastLine = line;
+
+		size_t fileNr = std::upper_bound(fileFirstLine.begin(), fileFirstLine.end(), (unsigned int)line) - fileFirstLine.begin() - 1;
+
+		std::string match = "Line: " + std::to_string(line - fileFirstLine[fileNr] + 1) + " Char: " + std::to_string(pos - lineStarts[line] + 1);
+
+		if (linesWithPatt[fileNr].empty())
+			linesWithPatt[fileNr] = match;
+		else
+			linesWithPatt[fileNr] += ", " + match;
+	}
+	return linesWithPatt;
+}
+
+/**
+ * @brief Get the amount of chars that were indexed.
+ *
+ * @return unsigned long long with the length of the corpus.
+ */
+unsigned long long fmIndex::corpusSize() {
+	return bwt.empty() ? 0 : bwt.size() - 1;
+}
+
+/**
+ * @brief Checks if the index was built.
+ *
+ * @return false if the files were too big to be indexed, true otherwise.
+ */
+bool fmIndex::good() {
+	return !bwt.empty();
+}
+
+/**
+ * @brief Get the amount of memory used by the index.
+ *
+ * @return unsigned long long with the size of the index in bytes.
+ */
+unsigned long long fmIndex::memoryUsage() {
+	return sizeof(*this)
+		+ bwt.size() * sizeof(unsigned char)
+		+ C.size() * sizeof(unsigned int)
+		+ occ.size() * sizeof(unsigned int)
+		+ sampledRows.size() * sizeof(unsigned long long)
+		+ sampledRank.size() * sizeof(unsigned int)
+		+ samples.size() * sizeof(unsigned int)
+		+ lineStarts.size() * sizeof(unsigned int)
+		+ fileFirstLine.size() * sizeof(unsigned int);
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+class fmIndex {
+private:
+
+	std::vector<unsigned char> bwt; //Burrows-Wheeler Transform of the corpus (the row of the sentinel holds a dummy value)
+	unsigned int primary = 0; //Row of the BWT where the sentinel is
+
+	short code[256]; //Maps every char of the corpus to a compact alphabet (only the chars that are present). -1 = not present
+	unsigned short sigma = 0; //Size of the compact alphabet
+	std::vector<unsigned int> C; //C[c] = number of chars in the corpus smaller than c (+1 for the sentinel)
+	std::vector<unsigned int> occ; //Occurrences of every char of the compact alphabet before each checkpoint of the BWT
+
+	std::vector<unsigned long long> sampledRows; //Bit vector that marks the rows of the BWT with a sampled suffix array value
+	std::vector<unsigned int> sampledRank; //Amount of marked rows before each word of sampledRows
+	std::vector<unsigned int> samples; //The sampled suffix array values
+
+	std::vector<unsigned int> lineStarts; //Position in the corpus of the first char of every line
+	std::vector<unsigned int> fileFirstLine; //Index in lineStarts of the first line of every file
+
+	static constexpr unsigned int checkpointRate = 256; //Distance between checkpoints of the occurrences table. Bigger = less memory, slower queries
+	static constexpr unsigned int maxCorpusSize = 2147483646; //Positions are stored as int while building the suffix array (INT_MAX - 1, for the sentinel)
+	static constexpr unsigned int sampleRate = 32; //Only the suffixes starting at multiples of this value are kept. Bigger = less memory, slower locate
+
+	static std::vector<int> suffixArray(const std::vector<int>&, const int&);
+	unsigned int rank(const unsigned char&, const unsigned int&);
+	unsigned int LF(const unsigned int&);
+	bool isSampled(const unsigned int&);
+	bool backwardSearch(const std::string&, unsigned int&, unsigned int&);
+
+public:
+
+	fmIndex(const std::vector<std::string>&);
+	~fmIndex();
+
+	unsigned int count(const std::string&);
+	std::vector<std::string> locate(const std::string&);
+	unsigned long long corpusSize();
+	unsigned long long memoryUsage();
+	bool good();
+};
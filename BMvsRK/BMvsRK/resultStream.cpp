@@ -0,0 +1,192 @@
+#include "resultStream.h"
+
+#include <iostream>
+
+/**
+ * @brief Constructor of the resultStream Class.
+ *
+ * The results can be pushed in any order (e.g. by different threads), but they are always written in the order of their index.
+ *
+ * @param nrResults The amount of results that will be pushed (one for each file).
+ * @param print Whether the results are supposed to be written to the screen or just timed.
+ */
+resultStream::resultStream(const size_t& nrResults, const bool& print) {
+	pending.resize(nrResults);
+	state.assign(nrResults, 0);
+	this->print = print;
+
+	start = std::chrono::steady_clock::now();
+	firstResult = start;
+	finish = start;
+
+	if (print)
+		flusher = std::thread(&resultStream::flushLoop, this);
+}
+
+/**
+ * @brief Destructor of the resultStream Class.
+ *
+ * Stops the flusher and writes whatever is still in the batch.
+ */
+resultStream::~resultStream() {
+	stop();
+	write();
+}
+
+/**
+ * @brief Runs in the flusher thread: writes the batch every flushInterval until the stream ends.
+ *
+ * Without it, a result that is already in order would only be written when the next result is pushed, which can take as long as searching the next file.
+ */
+void resultStream::flushLoop() {
+
+	std::unique_lock<std::mutex> guard(lock);
+
+	while (!stopping) {
+		stopFlusher.wait_for(guard, flushInterval);
+
+		if (!batch.empty())
+			write();
+	}
+}
+
+/**
+ * @brief Stops the flusher thread (if it's running) and waits for it to finish.
+ */
+void resultStream::stop() {
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		stopping = true;
+	}
+	stopFlusher.notify_all();
+
+	if (flusher.joinable())
+		flusher.join();
+}
+
+/**
+ * @brief Stores a result in the reorder buffer and moves every result that is now in order to the batch.
+ *
+ * The batch is written to the screen straight away for the first result (so the user sees something as soon as possible),
+ * and after that when it is big enough or by the flusher thread, every flushInterval.
+ *
+ * @param index The index of the result (i.e. the index of the file).
+ * @param text The result.
+ * @param type 1 for a result, 2 for an error.
+ */
+void resultStream::add(const size_t& index, const std::string& text, const char& type) {
+
+	std::lock_guard<std::mutex> guard(lock);
+
+	pending[index] = text;
+	state[index] = type;
+
+	bool first = false;
+
+	while (nextToWrite < state.size() && state[nextToWrite]) {
+
+		if (state[nextToWrite] == 2) { //Errors go to cerr, the results before it have to be written first
+			write();
+			std::cerr << pending[nextToWrite] << "\n\n";
+		}
+		else {
+			if (!hasFirstResult)
+				first = hasFirstResult = true;
+
+			if (print) {
+				batch += pending[nextToWrite];
+				batch += "\n\n";
+			}
+		}
+		std::string().swap(pending[nextToWrite]); //Free the memory of the results already written
+		nextToWrite++;
+	}
+
+	if (first || batch.size() >= batchSize)
+		write();
+
+	if (first)
+		firstResult = std::chrono::steady_clock::now();
+}
+
+/**
+ * @brief Writes the batch to the screen with a single write.
+ */
+void resultStream::write() {
+
+	if (!batch.empty()) {
+		std::cout.write(batch.data(), batch.size());
+		std::cout.flush();
+		batch.clear();
+	}
+}
+
+/**
+ * @brief Adds the result of a file to the stream.
+ *
+ * @param index The index of the file.
+ * @param result The result of the search in that file.
+ */
+void resultStream::push(const size_t& index, const std::string& result) {
+	add(index, result, 1);
+}
+
+/**
+ * @brief Adds an error of a file to the stream, it will be written to cerr when it's its turn.
+ *
+ * @param index The index of the file.
+ * @param message The error message.
+ */
+void resultStream::pushError(const size_t& index, const std::string& message) {
+	add(index, message, 2);
+}
+
+/**
+ * @brief Writes every result that is in order straight away (e.g. so the results aren't mixed up with the output of the verbose mode).
+ */
+void resultStream::flush() {
+	std::lock_guard<std::mutex> guard(lock);
+	write();
+}
+
+/**
+ * @brief Writes the remaining results and stops the clock. Should be called after every result was pushed.
+ */
+void resultStream::end() {
+	stop();
+
+	std::lock_guard<std::mutex> guard(lock);
+	write();
+
+	finish = std::chrono::steady_clock::now();
+
+	if (!hasFirstResult)
+		firstResult = finish;
+}
+
+/**
+ * @brief Get the time when the stream was created (i.e. when the search started).
+ *
+ * @return time_point with the start.
+ */
+std::chrono::steady_clock::time_point resultStream::getStart() {
+	return start;
+}
+
+/**
+ * @brief Get the time when the first result was written (or was ready, if the results aren't printed).
+ *
+ * @return time_point with the time of the first result.
+ */
+std::chrono::steady_clock::time_point resultStream::getFirstResult() {
+	return firstResult;
+}
+
+/**
+ * @brief Get the time when the stream ended (i.e. when the search ended).
+ *
+ * @return time_point with the finish.
+ */
+std::chrono::steady_clock::time_point resultStream::getFinish() {
+	return finish;
+}
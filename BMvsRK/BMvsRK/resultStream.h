@@ -0,0 +1,52 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+
+class resultStream {
+private:
+
+	std::vector<std::string> pending; //Reorder buffer: results that are ready but can't be written before the results of the previous files
+	std::vector<char> state; //0 = not ready, 1 = result, 2 = error
+	size_t nextToWrite = 0; //Index of the next result to be written
+
+	std::string batch; //Results waiting to be written all at once
+	bool print = true;
+
+	std::mutex lock;
+
+	std::thread flusher; //Writes the batch every flushInterval, even when no result is pushed for a long time (e.g. while a big file is searched)
+	std::condition_variable stopFlusher;
+	bool stopping = false;
+
+	std::chrono::steady_clock::time_point start;
+	std::chrono::steady_clock::time_point firstResult;
+	std::chrono::steady_clock::time_point finish;
+	bool hasFirstResult = false;
+
+	static constexpr size_t batchSize = 64 * 1024; //Write the batch when it gets this big (bytes)...
+	static constexpr std::chrono::milliseconds flushInterval{ 100 }; //...or, at the latest, after this long
+
+	void add(const size_t&, const std::string&, const char&);
+	void write();
+	void flushLoop();
+	void stop();
+
+public:
+
+	resultStream(const size_t&, const bool& = true);
+	~resultStream();
+
+	void push(const size_t&, const std::string&);
+	void pushError(const size_t&, const std::string&);
+	void flush();
+	void end();
+
+	std::chrono::steady_clock::time_point getStart();
+	std::chrono::steady_clock::time_point getFirstResult();
+	std::chrono::steady_clock::time_point getFinish();
+};